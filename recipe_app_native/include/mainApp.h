@@ -9,14 +9,27 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QSettings>
+#include <QFileSystemWatcher>
+#include <QThreadPool>
+#include <QReadWriteLock>
+#include <QTimer>
 
 // Added explicit includes for Qt types used as member pointers or values
 #include <QPushButton>
 #include <QLineEdit>
 #include <QLabel>
+#include <QComboBox>
+#include <QSpinBox>
 #include <QString>
 #include <QStringList>
 #include <QSet>
+#include <QHash>
+
+#include <functional>
+#include <memory>
+
+#include "similarityIndex.h"
+#include "sortIndex.h"
 
 // Small, focused data model for recipes used across views
 struct Recipe {
@@ -30,6 +43,53 @@ struct Recipe {
     QString image; // placeholder path or URL
 };
 
+inline bool operator==(const Recipe& a, const Recipe& b) {
+    return a.id == b.id && a.title == b.title && a.category == b.category
+        && a.description == b.description && a.ingredients == b.ingredients
+        && a.cookMinutes == b.cookMinutes && a.calories == b.calories && a.image == b.image;
+}
+inline bool operator!=(const Recipe& a, const Recipe& b) { return !(a == b); }
+
+// One immutable catalog version with its indexes. Readers hold it through a shared
+// pointer, so a reload swaps in a new snapshot without disturbing in-flight work.
+struct CatalogSnapshot {
+    quint64 version{0};
+    QList<Recipe> recipes;
+    QHash<QString, int> rowById;
+    SimilarityIndex similarity;
+    SortIndex sorts;
+};
+using CatalogPtr = std::shared_ptr<const CatalogSnapshot>;
+
+// Recipe ids that differ between two catalog snapshots
+struct CatalogDiff {
+    quint64 fromVersion{0};
+    quint64 toVersion{0};
+    QSet<QString> added;
+    QSet<QString> removed;
+    QSet<QString> changed;
+    bool isEmpty() const { return added.isEmpty() && removed.isEmpty() && changed.isEmpty(); }
+    QSet<QString> touched() const { return QSet<QString>(added).unite(removed).unite(changed); }
+};
+
+// Position in a sorted catalog. When the catalog version moved on, the cursor is
+// re-anchored to wherever its first recipe (anchorId) landed in the new order.
+struct PageCursor {
+    RecipeSort sort{RecipeSort::Title};
+    int position{0};
+    quint64 version{0};
+    QString anchorId;
+};
+
+// One page of a sorted catalog, a view over the precomputed order
+struct RecipePage {
+    QList<Recipe> items;
+    PageCursor cursor;
+    int total{0};
+    bool hasNext() const { return cursor.position + items.size() < total; }
+    bool hasPrev() const { return cursor.position > 0; }
+};
+
 // PUBLIC_INTERFACE
 class Theme {
 public:
@@ -65,12 +125,30 @@ public:
 class RecipeStore : public QObject {
     Q_OBJECT
 public:
-    /** In-app data layer with mock recipes and favorites persistence via QSettings. */
+    /** In-app data layer with mock recipes and favorites persistence via QSettings.
+     *  Queries and favorite toggles may be called from worker threads. */
     explicit RecipeStore(QObject* parent = nullptr);
+    ~RecipeStore() override;
+
+    // PUBLIC_INTERFACE
+    void setSettingsName(const QString& application);
+    /** Switches favorites to another QSettings application name (default "RecipeApp") and loads them. */
+
+    // PUBLIC_INTERFACE
+    void setCatalogPath(const QString& path);
+    /** Loads recipes from a JSON catalog file and reloads it in the background when it changes. */
+
+    // PUBLIC_INTERFACE
+    CatalogPtr snapshot() const;
+    /** Returns the current catalog snapshot. Safe to call from any thread. */
 
     // PUBLIC_INTERFACE
     QList<Recipe> allRecipes() const;
-    /** Returns all available mock recipes. */
+    /** Returns all recipes of the current catalog. */
+
+    // PUBLIC_INTERFACE
+    bool findRecipe(const QString& recipeId, Recipe* out) const;
+    /** Looks up a recipe by id in the current catalog. */
 
     // PUBLIC_INTERFACE
     QList<Recipe> search(const QString& query) const;
@@ -81,20 +159,52 @@ public:
     /** Returns whether a recipe is marked as favorite. */
 
     // PUBLIC_INTERFACE
-    void toggleFavorite(const QString& recipeId);
-    /** Toggles favorite state and persists to local device storage. */
+    bool toggleFavorite(const QString& recipeId);
+    /** Toggles favorite state, returns the new state and schedules persisting to local device storage. */
 
     // PUBLIC_INTERFACE
     QList<Recipe> favorites() const;
     /** Returns list of favorite recipes. */
 
+    // PUBLIC_INTERFACE
+    QList<Recipe> similar(const QString& recipeId, int limit = 5) const;
+    /** Returns same-category recipes with overlapping ingredients, most similar first. */
+
+    // PUBLIC_INTERFACE
+    SimilarityIndex::Stats similarityStats() const { return snapshot()->similarity.stats(); }
+    /** Returns build time and memory of the similar-recipes index. */
+
+    // PUBLIC_INTERFACE
+    RecipePage page(const PageCursor& cursor, int pageSize) const;
+    /** Returns pageSize recipes starting at cursor, read through the precomputed sort order.
+     *  A cursor from an older catalog version is re-anchored on its first recipe. */
+
+    // PUBLIC_INTERFACE
+    quint64 catalogVersion() const { return snapshot()->version; }
+    /** Returns a counter bumped whenever the catalog and its indexes are rebuilt. */
+
 signals:
     void favoritesChanged();
+    void catalogChanged(const CatalogDiff& diff);
+
+private slots:
+    void reloadCatalog();
 
 private:
-    QList<Recipe> m_recipes;
+    CatalogPtr m_catalog; // accessed through std::atomic_load/atomic_store only
     QSet<QString> m_favorites;
+    mutable QReadWriteLock m_favoritesLock;
+    QString m_settingsName{"RecipeApp"};
+    QTimer* m_saveTimer{nullptr};
+    QString m_catalogPath;
+    QString m_catalogStamp; // size and mtime seen when the catalog was last read
+    QFileSystemWatcher* m_watcher{nullptr};
+    QTimer* m_reloadTimer{nullptr};
+    bool m_reloadRunning{false};
+    bool m_reloadPending{false};
+    QThreadPool m_loader; // declared last: its destructor waits for a running reload
     void loadMockData();
+    void publish(CatalogPtr next, const CatalogDiff& diff);
     void loadFavorites();
     void saveFavorites() const;
 };
@@ -110,7 +220,7 @@ class MainWindow : public QMainWindow {
     Q_OBJECT
 public:
     /** Main window hosting stack-based navigation and top navigation bar. */
-    explicit MainWindow(QWidget* parent = nullptr);
+    explicit MainWindow(const QString& catalogPath = QString(), QWidget* parent = nullptr);
 
 private slots:
     void navigateHome();
@@ -122,6 +232,7 @@ private:
     RecipeStore m_store;
     QStackedWidget* m_stack;
     QWidget* createTopNav();
+    void showCatalogStatus();
     int m_homeIndex{-1};
     int m_searchIndex{-1};
     int m_favoritesIndex{-1};
@@ -132,6 +243,7 @@ class RecipeCard : public QWidget {
     Q_OBJECT
 public:
     explicit RecipeCard(const Recipe& recipe, bool favorite, QWidget* parent = nullptr);
+    const Recipe& recipe() const { return m_recipe; }
 
 signals:
     void openRequested(const Recipe& recipe);
@@ -152,9 +264,25 @@ public:
 signals:
     void openRecipe(const Recipe& recipe);
 
+private slots:
+    void onSortChanged(int index);
+    void onPageChanged(int page);
+
 private:
+    static constexpr int kPageSize = 20;
     RecipeStore* m_store;
+    PageCursor m_cursor;
+    QWidget* m_list{nullptr};
+    QComboBox* m_sortBox{nullptr};
+    QSpinBox* m_pageSpin{nullptr};
+    QLabel* m_pageTotal{nullptr};
+    QPushButton* m_prevBtn{nullptr};
+    QPushButton* m_nextBtn{nullptr};
     QWidget* buildList(const QList<Recipe>& items);
+    RecipeCard* createCard(const Recipe& recipe, QWidget* parent);
+    void showPage(const PageCursor& cursor);
+    void updatePager(const RecipePage& page);
+    void onCatalogChanged(const CatalogDiff& diff);
     void reload();
 };
 
@@ -174,7 +302,9 @@ private:
     RecipeStore* m_store;
     QLineEdit* m_searchEdit{nullptr};
     QWidget* m_results{nullptr};
+    RecipeCard* createCard(const Recipe& recipe, QWidget* parent);
     void renderResults(const QList<Recipe>& results);
+    void onCatalogChanged(const CatalogDiff& diff);
 };
 
 // Favorites
@@ -190,6 +320,7 @@ private:
     RecipeStore* m_store;
     QWidget* m_list{nullptr};
     void reload();
+    void onCatalogChanged(const CatalogDiff& diff);
 };
 
 // Detail
@@ -201,6 +332,7 @@ public:
 
 signals:
     void backRequested();
+    void openRecipe(const Recipe& recipe);
 
 private slots:
     void onToggleFavorite();
@@ -213,8 +345,11 @@ private:
     QLabel* m_desc{nullptr};
     QLabel* m_meta{nullptr};
     QLabel* m_ingredients{nullptr};
+    QWidget* m_similar{nullptr};
     QPushButton* m_favBtn{nullptr};
     void refreshFavorite();
+    void refreshSimilar();
+    void onCatalogChanged(const CatalogDiff& diff);
 };
 
 #endif // MAIN_APP_H
\ No newline at end of file
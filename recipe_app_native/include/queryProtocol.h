@@ -0,0 +1,26 @@
+#ifndef QUERY_PROTOCOL_H
+#define QUERY_PROTOCOL_H
+
+#include <QByteArray>
+#include <QCborMap>
+#include <QList>
+
+// PUBLIC_INTERFACE
+class QueryProtocol {
+public:
+    /** Framing for the local query socket: a 4-byte big-endian length followed by a CBOR map.
+     *  Requests carry "id" and "op" plus op arguments; replies echo "id" with "ok" and
+     *  either "result" or "error". */
+
+    static constexpr quint32 kMaxFrameBytes = 1u << 20;
+
+    // PUBLIC_INTERFACE
+    static QByteArray encodeFrame(const QCborMap& message);
+    /** Returns message serialized as one length-prefixed frame. */
+
+    // PUBLIC_INTERFACE
+    static bool takeFrames(QByteArray* buffer, QList<QCborMap>* out);
+    /** Moves every complete frame at the front of buffer into out. Returns false on an oversized frame. */
+};
+
+#endif // QUERY_PROTOCOL_H
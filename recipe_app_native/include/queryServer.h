@@ -0,0 +1,120 @@
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class QLocalServer;
+class QLocalSocket;
+class RecipeStore;
+
+// PUBLIC_INTERFACE
+class QueryServer : public QObject {
+    Q_OBJECT
+public:
+    /** Headless front end serving RecipeStore search, facets, lookup and favorite toggles
+     *  over a QLocalServer socket using QueryProtocol frames. */
+    explicit QueryServer(RecipeStore* store, QObject* parent = nullptr);
+    ~QueryServer() override;
+
+    // PUBLIC_INTERFACE
+    bool listen(const QString& name, int threads = 0);
+    /** Starts accepting connections on name. threads <= 0 uses one worker per core. */
+
+    // PUBLIC_INTERFACE
+    QString errorString() const;
+    /** Returns the last listen error. */
+
+private slots:
+    void onNewConnection();
+
+private:
+    enum Endpoint { Search, Facets, Lookup, Favorite, Stats, Invalid, EndpointCount };
+
+    // Latency runs from the moment a frame is taken off the socket to the moment its reply
+    // is written back, so it includes queueing behind earlier batches.
+    struct Bucket {
+        qint64 second{-1}; // uptime second this bucket covers; -1 while unused
+        quint64 requests{0};
+        quint64 errors{0};
+        quint64 totalUs{0};
+        quint64 maxUs{0};
+    };
+
+    // Rates and latency are reported both for the server lifetime and for the last
+    // kWindowSeconds full seconds, kept as a ring of one-second buckets.
+    static constexpr int kWindowSeconds = 10;
+    struct Counters {
+        Bucket lifetime;
+        Bucket recent[kWindowSeconds + 1]; // +1: the second still being filled
+    };
+
+    // Frames that arrive while a batch is running queue up and form the next batch,
+    // which keeps replies in request order per connection.
+    struct Connection {
+        QLocalSocket* socket{nullptr};
+        QByteArray buffer;
+        QList<QCborMap> queued;
+        QList<qint64> queuedAtNs; // receipt time of each queued frame, from m_uptime
+        bool busy{false};
+    };
+
+    // Read-only runs shorter than this run on one worker; longer ones are split across the pool.
+    static constexpr int kMinChunk = 32;
+    // Backpressure: a batch takes at most kMaxBatchFrames queued frames. A connection stops
+    // being read while it has kMaxQueuedFrames waiting or kMaxPendingWriteBytes of unsent
+    // replies, and resumes once its batch finishes or the client drains replies. The socket
+    // read buffer is capped too, so a client that keeps sending blocks in the kernel.
+    static constexpr int kMaxBatchFrames = 256;
+    static constexpr int kMaxQueuedFrames = 1024;
+    static constexpr qint64 kMaxPendingWriteBytes = 4 * 1024 * 1024;
+    static constexpr qint64 kReadBufferBytes = 256 * 1024;
+
+    // One dispatched batch, executed as phases: runs of read-only requests (split across the
+    // pool) and single mutating requests, each phase starting after the previous one finished.
+    struct Batch {
+        quint64 connectionId{0};
+        QList<QCborMap> requests;
+        QList<qint64> receivedAtNs;
+        std::vector<QByteArray> replies;
+        std::vector<Endpoint> endpoints; // filled by handle(), read when the batch finishes
+        std::vector<char> failed;
+        std::vector<std::pair<int, int>> phases; // [begin, end) into requests
+        std::atomic<int> remaining{0};
+    };
+
+    RecipeStore* m_store;
+    QLocalServer* m_server{nullptr};
+    QString m_error;
+    QHash<quint64, Connection> m_connections;
+    quint64 m_nextConnectionId{1};
+    QElapsedTimer m_uptime;
+    mutable QMutex m_countersLock; // taken once per finished batch and per stats request
+    Counters m_counters[EndpointCount];
+    std::atomic<quint64> m_batches{0};
+    std::atomic<quint64> m_batchedRequests{0};
+    QThreadPool m_pool; // declared last: its destructor waits for running batches
+
+    void onReadyRead(quint64 connectionId);
+    bool isBackedUp(const Connection& connection) const;
+    void dispatch(quint64 connectionId);
+    void runPhase(const std::shared_ptr<Batch>& batch, int phase);
+    void finishBatch(const std::shared_ptr<Batch>& batch);
+    QCborMap handle(const QCborMap& request, Endpoint* endpoint);
+    QCborValue stats() const;
+};
+
+#endif // QUERY_SERVER_H
@@ -0,0 +1,60 @@
+#ifndef SIMILARITY_INDEX_H
+#define SIMILARITY_INDEX_H
+
+#include <QList>
+#include <QVector>
+#include <QtGlobal>
+
+#include <vector>
+
+struct Recipe;
+
+// PUBLIC_INTERFACE
+class SimilarityIndex {
+public:
+    /** MinHash/LSH index over ingredient sets, bucketed by category. Built once per catalog load. */
+
+    struct Stats {
+        int recipes{0};
+        qint64 buildMs{0};
+        qint64 bytes{0};
+    };
+
+    // PUBLIC_INTERFACE
+    void build(const QList<Recipe>& recipes);
+    /** Computes MinHash signatures and LSH band buckets. Rows are positions in recipes. */
+
+    // PUBLIC_INTERFACE
+    QVector<int> similar(int row, int limit) const;
+    /** Returns rows in the same category sharing ingredients with row, best Jaccard match first. */
+
+    // PUBLIC_INTERFACE
+    Stats stats() const { return m_stats; }
+    /** Returns size and build time of the last build. */
+
+private:
+    // 15 bands of 2 rows: candidates kick in around Jaccard 0.26 ((1/15)^(1/2)), which is
+    // where recipes with 5-10 ingredients sharing a few of them actually land.
+    static constexpr int kBands = 15;
+    static constexpr int kRowsPerBand = 2;
+    static constexpr int kHashes = kBands * kRowsPerBand;
+    // Upper bound on entries sampled per bucket so very common ingredient sets stay cheap.
+    static constexpr int kMaxBucketScan = 64;
+
+    struct BandEntry {
+        quint32 key;
+        quint32 row;
+    };
+
+    std::vector<BandEntry> m_bands[kBands]; // sorted by (key, row)
+    std::vector<quint32> m_tokenOffsets;    // row -> start of its tokens in m_tokens
+    std::vector<quint32> m_tokens;          // sorted, de-duplicated ingredient ids per row
+    std::vector<quint64> m_tokenHashes;     // ingredient id -> base hash
+    std::vector<quint32> m_categories;      // row -> interned category id
+    Stats m_stats;
+
+    void bandKeys(int row, quint32* keys) const;
+    double jaccard(int a, int b) const;
+};
+
+#endif // SIMILARITY_INDEX_H
@@ -0,0 +1,46 @@
+#ifndef SORT_INDEX_H
+#define SORT_INDEX_H
+
+#include <QList>
+#include <QVector>
+#include <QtGlobal>
+
+struct Recipe;
+
+// Sort orders offered when browsing the catalog
+enum class RecipeSort {
+    Title,
+    CookTime,
+    Calories,
+    Category
+};
+
+// PUBLIC_INTERFACE
+class SortIndex {
+public:
+    /** Precomputed row permutations for every RecipeSort, built once per catalog version. */
+
+    // PUBLIC_INTERFACE
+    void build(const QList<Recipe>& recipes);
+    /** Sorts row numbers for every mode. Titles use locale-aware collation sort keys. */
+
+    // PUBLIC_INTERFACE
+    const QVector<int>& order(RecipeSort sort) const { return m_orders[int(sort)]; }
+    /** Returns rows of the catalog in the given order. */
+
+    // PUBLIC_INTERFACE
+    int position(RecipeSort sort, int row) const { return m_positions[int(sort)].value(row, -1); }
+    /** Returns where row sits in the given order, or -1 for an unknown row. */
+
+    // PUBLIC_INTERFACE
+    qint64 buildMs() const { return m_buildMs; }
+    /** Returns how long the last build took. */
+
+private:
+    static constexpr int kSortCount = int(RecipeSort::Category) + 1;
+    QVector<int> m_orders[kSortCount];
+    QVector<int> m_positions[kSortCount]; // inverse of m_orders
+    qint64 m_buildMs{0};
+};
+
+#endif // SORT_INDEX_H
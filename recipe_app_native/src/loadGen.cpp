@@ -0,0 +1,198 @@
+// Load generator for `MainApp --serve`: opens several local socket connections, keeps a
+// window of pipelined requests in flight on each, and reports throughput and latency.
+
+#include "queryProtocol.h"
+
+#include <QCborArray>
+#include <QCborValue>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QLocalSocket>
+#include <QStringList>
+#include <QTextStream>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    QString socketName;
+    QString op;
+    QStringList queries;
+    QStringList ids;
+    int connections{4};
+    int depth{32};
+    int durationMs{5000};
+};
+
+struct WorkerResult {
+    quint64 errors{0};
+    std::vector<qint64> latenciesUs;
+    QString failure;
+};
+
+QCborMap makeRequest(const Options& opts, qint64 id) {
+    static const QStringList kMix = {"search", "facets", "lookup"};
+    const QString op = opts.op == "mix" ? kMix[id % kMix.size()] : opts.op;
+    QCborMap request;
+    request.insert(QStringLiteral("id"), id);
+    request.insert(QStringLiteral("op"), op);
+    if (op == "lookup" || op == "favorite") {
+        request.insert(QStringLiteral("recipeId"), opts.ids[id % opts.ids.size()]);
+    } else {
+        request.insert(QStringLiteral("q"), opts.queries[id % opts.queries.size()]);
+    }
+    return request;
+}
+
+// Reads replies until expected frames arrived, recording each one's latency from elapsed.
+bool readReplies(QLocalSocket* socket, int expected, const QElapsedTimer& elapsed, QByteArray* buffer,
+                 WorkerResult* result) {
+    QList<QCborMap> replies;
+    int received = 0;
+    while (received < expected) {
+        if (!socket->waitForReadyRead(5000)) {
+            result->failure = socket->errorString();
+            return false;
+        }
+        buffer->append(socket->readAll());
+        replies.clear();
+        if (!QueryProtocol::takeFrames(buffer, &replies)) {
+            result->failure = "malformed reply";
+            return false;
+        }
+        const qint64 us = elapsed.nsecsElapsed() / 1000;
+        for (const auto& reply : replies) {
+            if (!reply.value(QStringLiteral("ok")).toBool()) ++result->errors;
+            result->latenciesUs.push_back(us);
+        }
+        received += replies.size();
+    }
+    return true;
+}
+
+void runWorker(const Options& opts, int worker, WorkerResult* result) {
+    QLocalSocket socket;
+    socket.connectToServer(opts.socketName);
+    if (!socket.waitForConnected(3000)) {
+        result->failure = socket.errorString();
+        return;
+    }
+
+    QByteArray buffer;
+    qint64 nextId = qint64(worker) << 32;
+    QDeadlineTimer deadline(opts.durationMs);
+    while (!deadline.hasExpired()) {
+        QByteArray window;
+        for (int i = 0; i < opts.depth; ++i) window.append(QueryProtocol::encodeFrame(makeRequest(opts, nextId++)));
+        QElapsedTimer elapsed;
+        elapsed.start();
+        socket.write(window);
+        if (!socket.waitForBytesWritten(5000) && socket.bytesToWrite() > 0) {
+            result->failure = socket.errorString();
+            return;
+        }
+        if (!readReplies(&socket, opts.depth, elapsed, &buffer, result)) return;
+    }
+    socket.disconnectFromServer();
+}
+
+QCborValue fetchServerStats(const QString& socketName) {
+    QLocalSocket socket;
+    socket.connectToServer(socketName);
+    if (!socket.waitForConnected(3000)) return {};
+    QCborMap request;
+    request.insert(QStringLiteral("id"), 0);
+    request.insert(QStringLiteral("op"), QStringLiteral("stats"));
+    socket.write(QueryProtocol::encodeFrame(request));
+    socket.waitForBytesWritten(3000);
+
+    QByteArray buffer;
+    QList<QCborMap> replies;
+    while (replies.isEmpty() && socket.waitForReadyRead(3000)) {
+        buffer.append(socket.readAll());
+        QueryProtocol::takeFrames(&buffer, &replies);
+    }
+    return replies.isEmpty() ? QCborValue() : replies.first().value(QStringLiteral("result"));
+}
+
+qint64 percentile(const std::vector<qint64>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    return sorted[std::min(sorted.size() - 1, size_t(p * (sorted.size() - 1) + 0.5))];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Load generator for the Recipe Explorer query server (MainApp --serve)");
+    parser.addHelpOption();
+    QCommandLineOption socketOption("socket", "Local socket name of the server.", "name", "recipe-explorer");
+    QCommandLineOption connectionsOption("connections", "Concurrent client connections.", "count", "4");
+    QCommandLineOption depthOption("depth", "Pipelined requests in flight per connection.", "count", "32");
+    QCommandLineOption durationOption("duration", "Run time in seconds.", "seconds", "5");
+    QCommandLineOption opOption("op",
+        "search, facets, lookup, favorite or mix (search/facets/lookup). favorite toggles real favorites: "
+        "start the server with --settings <name> first.", "op", "search");
+    QCommandLineOption queriesOption("queries", "Comma-separated search terms.", "terms",
+                                     "salmon,garlic,lemon,pasta,beef,salt,quinoa");
+    QCommandLineOption idsOption("ids", "Comma-separated recipe ids for lookup and favorite.", "ids", "r1,r2,r3,r4,r5");
+    parser.addOptions({socketOption, connectionsOption, depthOption, durationOption, opOption, queriesOption, idsOption});
+    parser.process(app);
+
+    Options opts;
+    opts.socketName = parser.value(socketOption);
+    opts.op = parser.value(opOption);
+    opts.queries = parser.value(queriesOption).split(',');
+    opts.ids = parser.value(idsOption).split(',', Qt::SkipEmptyParts);
+    opts.connections = qMax(1, parser.value(connectionsOption).toInt());
+    opts.depth = qMax(1, parser.value(depthOption).toInt());
+    opts.durationMs = qMax(1, parser.value(durationOption).toInt()) * 1000;
+
+    QTextStream out(stdout);
+    if (opts.ids.isEmpty()) {
+        out << "--ids must name at least one recipe\n";
+        return 2;
+    }
+
+    std::vector<WorkerResult> results(opts.connections);
+    std::vector<std::thread> workers;
+    QElapsedTimer wall;
+    wall.start();
+    for (int i = 0; i < opts.connections; ++i) workers.emplace_back(runWorker, std::cref(opts), i, &results[i]);
+    for (auto& w : workers) w.join();
+    const double seconds = wall.nsecsElapsed() / 1e9;
+
+    std::vector<qint64> latencies;
+    quint64 errors = 0;
+    for (const auto& r : results) {
+        if (!r.failure.isEmpty()) out << "connection failed: " << r.failure << "\n";
+        latencies.insert(latencies.end(), r.latenciesUs.begin(), r.latenciesUs.end());
+        errors += r.errors;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    out << QString("op=%1 connections=%2 depth=%3\n").arg(opts.op).arg(opts.connections).arg(opts.depth);
+    out << QString("requests=%1 errors=%2 seconds=%3 qps=%4\n")
+               .arg(latencies.size())
+               .arg(errors)
+               .arg(seconds, 0, 'f', 2)
+               .arg(latencies.size() / seconds, 0, 'f', 0);
+    out << QString("latency us: p50=%1 p99=%2 max=%3\n")
+               .arg(percentile(latencies, 0.50))
+               .arg(percentile(latencies, 0.99))
+               .arg(latencies.empty() ? 0 : latencies.back());
+
+    const auto stats = fetchServerStats(opts.socketName);
+    if (!stats.isUndefined()) {
+        out << "server stats:\n" << QJsonDocument(stats.toJsonValue().toObject()).toJson();
+    }
+    return latencies.empty() ? 1 : 0;
+}
@@ -1,4 +1,5 @@
 #include "mainApp.h"
+#include "queryServer.h"
 #include <QApplication>
 #include <QLabel>
 #include <QVBoxLayout>
@@ -13,16 +14,141 @@
 #include <QGroupBox>
 #include <QSizePolicy>
 #include <QFrame>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QCommandLineParser>
+#include <QSocketNotifier>
+
+#ifdef Q_OS_UNIX
+#include <csignal>
+#include <unistd.h>
+#endif
+
+// ========== Catalog loading ==========
+namespace {
+
+// Reads a JSON catalog: either an array of recipe objects or {"recipes": [...]}.
+bool readCatalogFile(const QString& path, QList<Recipe>* out, QString* error) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = file.errorString();
+        return false;
+    }
+    QJsonParseError parseError;
+    const auto doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        *error = parseError.errorString();
+        return false;
+    }
+    if (!doc.isArray() && !doc.object().value("recipes").isArray()) {
+        *error = "expected an array of recipes";
+        return false;
+    }
+    const auto items = doc.isArray() ? doc.array() : doc.object().value("recipes").toArray();
+
+    out->clear();
+    out->reserve(items.size());
+    for (const auto& value : items) {
+        const auto o = value.toObject();
+        Recipe r;
+        r.id = o.value("id").toString();
+        if (r.id.isEmpty()) continue;
+        r.title = o.value("title").toString();
+        r.category = o.value("category").toString();
+        r.description = o.value("description").toString();
+        for (const auto& ing : o.value("ingredients").toArray()) r.ingredients.push_back(ing.toString());
+        r.cookMinutes = o.value("cookMinutes").toInt();
+        r.calories = o.value("calories").toInt();
+        r.image = o.value("image").toString();
+        out->push_back(r);
+    }
+    return true;
+}
+
+// Builds every index for recipes. Runs on the loader thread for reloads.
+CatalogPtr buildSnapshot(QList<Recipe> recipes, quint64 version) {
+    auto snap = std::make_shared<CatalogSnapshot>();
+    snap->version = version;
+    snap->recipes = std::move(recipes);
+    snap->rowById.reserve(snap->recipes.size());
+    for (int i = 0; i < snap->recipes.size(); ++i) {
+        if (!snap->rowById.contains(snap->recipes[i].id)) snap->rowById.insert(snap->recipes[i].id, i);
+    }
+    snap->similarity.build(snap->recipes);
+    snap->sorts.build(snap->recipes);
+
+    const auto stats = snap->similarity.stats();
+    qInfo().noquote() << QString("Catalog v%1: similarity index %2 recipes in %3 ms, %4 KiB; sort orders in %5 ms")
+                             .arg(version)
+                             .arg(stats.recipes)
+                             .arg(stats.buildMs)
+                             .arg(stats.bytes / 1024.0, 0, 'f', 1)
+                             .arg(snap->sorts.buildMs());
+    return snap;
+}
+
+// Size and mtime of the catalog file, or empty when it is missing.
+QString catalogStamp(const QString& path) {
+    const QFileInfo info(path);
+    if (!info.exists()) return QString();
+    return QString("%1@%2").arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch());
+}
+
+CatalogDiff diffCatalogs(const CatalogSnapshot& from, const CatalogSnapshot& to) {
+    CatalogDiff diff;
+    diff.fromVersion = from.version;
+    diff.toVersion = to.version;
+    for (auto it = from.rowById.constBegin(); it != from.rowById.constEnd(); ++it) {
+        const auto next = to.rowById.constFind(it.key());
+        if (next == to.rowById.constEnd()) {
+            diff.removed.insert(it.key());
+        } else if (from.recipes[it.value()] != to.recipes[next.value()]) {
+            diff.changed.insert(it.key());
+        }
+    }
+    for (auto it = to.rowById.constBegin(); it != to.rowById.constEnd(); ++it) {
+        if (!from.rowById.contains(it.key())) diff.added.insert(it.key());
+    }
+    return diff;
+}
+
+} // namespace
 
 // ========== RecipeStore ==========
 RecipeStore::RecipeStore(QObject* parent) : QObject(parent) {
+    m_loader.setMaxThreadCount(1);
+    // Toggles only touch memory; the settings file is rewritten at most once per interval.
+    m_saveTimer = new QTimer(this);
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(200);
+    connect(m_saveTimer, &QTimer::timeout, this, &RecipeStore::saveFavorites);
     loadMockData();
     loadFavorites();
 }
 
+RecipeStore::~RecipeStore() {
+    if (m_saveTimer->isActive()) saveFavorites();
+}
+
+void RecipeStore::setSettingsName(const QString& application) {
+    if (m_saveTimer->isActive()) {
+        m_saveTimer->stop();
+        saveFavorites();
+    }
+    {
+        QWriteLocker locker(&m_favoritesLock);
+        m_settingsName = application;
+        m_favorites.clear();
+    }
+    loadFavorites();
+    emit favoritesChanged();
+}
+
 void RecipeStore::loadMockData() {
     // Simple static mock dataset
-    m_recipes = {
+    QList<Recipe> recipes = {
         {"r1", "Grilled Salmon with Lemon", "Seafood",
          "A simple, healthy grilled salmon with lemon and herbs.",
          {"Salmon fillet", "Lemon", "Olive oil", "Garlic", "Parsley", "Salt", "Pepper"},
@@ -44,24 +170,122 @@ void RecipeStore::loadMockData() {
          {"Beef", "Bell peppers", "Onion", "Soy sauce", "Ginger", "Garlic"},
          22, 540, ""}
     };
+    std::atomic_store(&m_catalog, buildSnapshot(std::move(recipes), 1));
+}
+
+void RecipeStore::setCatalogPath(const QString& path) {
+    m_catalogPath = path;
+    if (path.isEmpty()) return;
+
+    // The first load is synchronous so the UI starts on the real catalog.
+    m_catalogStamp = catalogStamp(path);
+    QList<Recipe> recipes;
+    QString error;
+    if (readCatalogFile(path, &recipes, &error)) {
+        const auto current = snapshot();
+        auto next = buildSnapshot(std::move(recipes), current->version + 1);
+        publish(next, diffCatalogs(*current, *next));
+    } else {
+        qWarning().noquote() << QString("Cannot load catalog %1: %2").arg(path, error);
+    }
+
+    if (!m_watcher) {
+        m_reloadTimer = new QTimer(this);
+        m_reloadTimer->setSingleShot(true);
+        m_reloadTimer->setInterval(300); // publishers often write in several chunks
+        connect(m_reloadTimer, &QTimer::timeout, this, &RecipeStore::reloadCatalog);
+
+        m_watcher = new QFileSystemWatcher(this);
+        connect(m_watcher, &QFileSystemWatcher::fileChanged, m_reloadTimer, qOverload<>(&QTimer::start));
+        // Watching the directory catches catalogs replaced by rename, which drops the file watch.
+        // Other files in that directory change too, so only react when the catalog itself did.
+        connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, [this]() {
+            if (catalogStamp(m_catalogPath) != m_catalogStamp) m_reloadTimer->start();
+        });
+    }
+    const auto watched = m_watcher->files() + m_watcher->directories();
+    if (!watched.isEmpty()) m_watcher->removePaths(watched);
+    m_watcher->addPath(QFileInfo(path).absolutePath());
+    if (QFileInfo::exists(path)) m_watcher->addPath(path);
+}
+
+void RecipeStore::reloadCatalog() {
+    if (m_catalogPath.isEmpty()) return;
+    if (QFileInfo::exists(m_catalogPath) && !m_watcher->files().contains(m_catalogPath)) {
+        m_watcher->addPath(m_catalogPath);
+    }
+    if (m_reloadRunning) {
+        m_reloadPending = true;
+        return;
+    }
+    m_reloadRunning = true;
+    m_catalogStamp = catalogStamp(m_catalogPath);
+
+    const auto path = m_catalogPath;
+    const auto current = snapshot();
+    // Loads are serialized, so current is still the published snapshot when this one lands.
+    m_loader.start([this, path, current]() {
+        QList<Recipe> recipes;
+        QString error;
+        CatalogPtr next;
+        CatalogDiff diff;
+        if (readCatalogFile(path, &recipes, &error)) {
+            next = buildSnapshot(std::move(recipes), current->version + 1);
+            diff = diffCatalogs(*current, *next);
+        } else {
+            qWarning().noquote() << QString("Keeping catalog v%1, reload of %2 failed: %3")
+                                        .arg(current->version)
+                                        .arg(path, error);
+        }
+        QMetaObject::invokeMethod(this, [this, next, diff]() {
+            m_reloadRunning = false;
+            if (next) publish(next, diff);
+            if (m_reloadPending) {
+                m_reloadPending = false;
+                reloadCatalog();
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+void RecipeStore::publish(CatalogPtr next, const CatalogDiff& diff) {
+    // A rewrite with identical content keeps the current version and leaves views alone.
+    if (diff.isEmpty()) return;
+    // Readers that already hold the previous snapshot keep it alive until they finish.
+    std::atomic_store(&m_catalog, next);
+    // Favorites are stored by id, so ids that survive the reload keep their state untouched.
+    emit catalogChanged(diff);
+}
+
+CatalogPtr RecipeStore::snapshot() const {
+    return std::atomic_load(&m_catalog);
 }
 
 void RecipeStore::loadFavorites() {
-    QSettings settings("RecipeExplorer", "RecipeApp");
+    QSet<QString> loaded;
+    QSettings settings("RecipeExplorer", m_settingsName);
     int size = settings.beginReadArray("favorites");
     for (int i = 0; i < size; ++i) {
         settings.setArrayIndex(i);
-        m_favorites.insert(settings.value("id").toString());
+        loaded.insert(settings.value("id").toString());
     }
     settings.endArray();
+    QWriteLocker locker(&m_favoritesLock);
+    m_favorites.unite(loaded);
 }
 
 void RecipeStore::saveFavorites() const {
-    QSettings settings("RecipeExplorer", "RecipeApp");
+    // Copy under the lock and write outside it so queries never wait on disk I/O.
+    QSet<QString> favorites;
+    {
+        QReadLocker locker(&m_favoritesLock);
+        favorites = m_favorites;
+    }
+    QSettings settings("RecipeExplorer", m_settingsName);
     settings.remove("favorites");
     settings.beginWriteArray("favorites");
     int i = 0;
-    for (const auto& id : m_favorites) {
+    for (const auto& id : favorites) {
         settings.setArrayIndex(i++);
         settings.setValue("id", id);
     }
@@ -69,14 +293,23 @@ void RecipeStore::saveFavorites() const {
 }
 
 QList<Recipe> RecipeStore::allRecipes() const {
-    return m_recipes;
+    return snapshot()->recipes;
+}
+
+bool RecipeStore::findRecipe(const QString& recipeId, Recipe* out) const {
+    const auto snap = snapshot();
+    const auto it = snap->rowById.constFind(recipeId);
+    if (it == snap->rowById.constEnd()) return false;
+    *out = snap->recipes[it.value()];
+    return true;
 }
 
 QList<Recipe> RecipeStore::search(const QString& query) const {
-    if (query.trimmed().isEmpty()) return m_recipes;
+    const auto snap = snapshot();
+    if (query.trimmed().isEmpty()) return snap->recipes;
     QList<Recipe> out;
     const auto q = query.trimmed().toLower();
-    for (const auto& r : m_recipes) {
+    for (const auto& r : snap->recipes) {
         if (r.title.toLower().contains(q)) {
             out.push_back(r);
             continue;
@@ -92,27 +325,74 @@ QList<Recipe> RecipeStore::search(const QString& query) const {
 }
 
 bool RecipeStore::isFavorite(const QString& recipeId) const {
+    QReadLocker locker(&m_favoritesLock);
     return m_favorites.contains(recipeId);
 }
 
-void RecipeStore::toggleFavorite(const QString& recipeId) {
-    if (m_favorites.contains(recipeId)) {
-        m_favorites.remove(recipeId);
-    } else {
-        m_favorites.insert(recipeId);
+bool RecipeStore::toggleFavorite(const QString& recipeId) {
+    bool favorite;
+    {
+        QWriteLocker locker(&m_favoritesLock);
+        favorite = !m_favorites.contains(recipeId);
+        if (favorite) {
+            m_favorites.insert(recipeId);
+        } else {
+            m_favorites.remove(recipeId);
+        }
     }
-    saveFavorites();
+    // Toggles may come from server workers; the timer lives on the store's thread.
+    QMetaObject::invokeMethod(m_saveTimer, [this]() {
+        if (!m_saveTimer->isActive()) m_saveTimer->start();
+    });
     emit favoritesChanged();
+    return favorite;
 }
 
 QList<Recipe> RecipeStore::favorites() const {
+    QReadLocker locker(&m_favoritesLock);
     QList<Recipe> out;
-    for (const auto& r : m_recipes) {
+    for (const auto& r : snapshot()->recipes) {
         if (m_favorites.contains(r.id)) out.push_back(r);
     }
     return out;
 }
 
+QList<Recipe> RecipeStore::similar(const QString& recipeId, int limit) const {
+    QList<Recipe> out;
+    const auto snap = snapshot();
+    const auto it = snap->rowById.constFind(recipeId);
+    if (it == snap->rowById.constEnd()) return out;
+    for (int row : snap->similarity.similar(it.value(), limit)) out.push_back(snap->recipes[row]);
+    return out;
+}
+
+RecipePage RecipeStore::page(const PageCursor& cursor, int pageSize) const {
+    const auto snap = snapshot();
+    RecipePage out;
+    const auto& order = snap->sorts.order(cursor.sort);
+    out.total = order.size();
+    if (pageSize <= 0) {
+        out.cursor = {cursor.sort, 0, snap->version, QString()};
+        return out;
+    }
+
+    int start = qMax(0, cursor.position);
+    if (cursor.version != 0 && cursor.version != snap->version && !cursor.anchorId.isEmpty()) {
+        // Stale cursor: follow its first recipe to the page it is on now. If that recipe
+        // was removed, the old offset is the best remaining guess.
+        const auto row = snap->rowById.constFind(cursor.anchorId);
+        if (row != snap->rowById.constEnd()) start = snap->sorts.position(cursor.sort, row.value()) / pageSize * pageSize;
+    }
+    // Past the end (including an empty catalog): fall back to the last page, or 0.
+    start = qMin(start, qMax(0, (out.total - 1) / pageSize * pageSize));
+    const int end = qMin(start + pageSize, out.total);
+
+    out.items.reserve(end - start);
+    for (int i = start; i < end; ++i) out.items.push_back(snap->recipes[order[i]]);
+    out.cursor = {cursor.sort, start, snap->version, out.items.isEmpty() ? QString() : out.items.first().id};
+    return out;
+}
+
 // ========== RecipeCard ==========
 RecipeCard::RecipeCard(const Recipe& recipe, bool favorite, QWidget* parent)
     : QWidget(parent), m_recipe(recipe) {
@@ -165,6 +445,44 @@ void RecipeCard::updateFavIcon(bool fav) {
         : QString("QPushButton { background: %1; color: %2; }").arg(Theme::surface(), Theme::text()));
 }
 
+// ========== Card list helpers ==========
+namespace {
+
+// Card layout inside a holder that contains a single QScrollArea (Home list, Search results).
+QVBoxLayout* cardsLayoutOf(QWidget* holder) {
+    auto* item = holder->layout() ? holder->layout()->itemAt(0) : nullptr;
+    auto* scroll = item ? qobject_cast<QScrollArea*>(item->widget()) : nullptr;
+    return scroll && scroll->widget() ? qobject_cast<QVBoxLayout*>(scroll->widget()->layout()) : nullptr;
+}
+
+// Reorders the cards in v to match items after a catalog reload. Cards whose id is not
+// in stale are kept as they are; only new or changed rows get a fresh card.
+void syncCards(QVBoxLayout* v, const QList<Recipe>& items, const QSet<QString>& stale,
+               const std::function<RecipeCard*(const Recipe&)>& makeCard) {
+    QHash<QString, RecipeCard*> existing;
+    QLayoutItem* child;
+    while ((child = v->takeAt(0)) != nullptr) {
+        if (auto* card = qobject_cast<RecipeCard*>(child->widget())) existing.insert(card->recipe().id, card);
+        delete child;
+    }
+    for (const auto& r : items) {
+        RecipeCard* card = existing.take(r.id);
+        if (card && stale.contains(r.id)) {
+            card->hide();
+            card->deleteLater();
+            card = nullptr;
+        }
+        v->addWidget(card ? card : makeCard(r));
+    }
+    for (auto* card : std::as_const(existing)) {
+        card->hide();
+        card->deleteLater();
+    }
+    v->addStretch();
+}
+
+} // namespace
+
 // ========== HomeView ==========
 HomeView::HomeView(RecipeStore* store, QWidget* parent)
     : QWidget(parent), m_store(store) {
@@ -172,14 +490,105 @@ HomeView::HomeView(RecipeStore* store, QWidget* parent)
     layout->setContentsMargins(12, 12, 12, 12);
     layout->setSpacing(12);
 
+    auto* top = new QHBoxLayout();
     auto* header = new QLabel("Discover", this);
     header->setObjectName("Title");
-    layout->addWidget(header);
+    m_sortBox = new QComboBox(this);
+    m_sortBox->addItem("Title", int(RecipeSort::Title));
+    m_sortBox->addItem("Cook time", int(RecipeSort::CookTime));
+    m_sortBox->addItem("Calories", int(RecipeSort::Calories));
+    m_sortBox->addItem("Category", int(RecipeSort::Category));
+    top->addWidget(header);
+    top->addStretch();
+    top->addWidget(new QLabel("Sort by", this));
+    top->addWidget(m_sortBox);
+
+    m_list = new QWidget(this);
+    auto* listLayout = new QVBoxLayout(m_list);
+    listLayout->setContentsMargins(0, 0, 0, 0);
+    listLayout->setSpacing(0);
+
+    auto* pager = new QHBoxLayout();
+    m_prevBtn = new QPushButton("← Prev", this);
+    m_nextBtn = new QPushButton("Next →", this);
+    m_pageSpin = new QSpinBox(this);
+    m_pageSpin->setMinimum(1);
+    m_pageTotal = new QLabel(this);
+    pager->addWidget(m_prevBtn);
+    pager->addStretch();
+    pager->addWidget(new QLabel("Page", this));
+    pager->addWidget(m_pageSpin);
+    pager->addWidget(m_pageTotal);
+    pager->addStretch();
+    pager->addWidget(m_nextBtn);
+
+    layout->addLayout(top);
+    layout->addWidget(m_list, 1);
+    layout->addLayout(pager);
+
+    connect(m_sortBox, qOverload<int>(&QComboBox::currentIndexChanged), this, &HomeView::onSortChanged);
+    connect(m_pageSpin, qOverload<int>(&QSpinBox::valueChanged), this, &HomeView::onPageChanged);
+    // Page moves are explicit offsets in the version on screen, so they carry no anchor.
+    connect(m_prevBtn, &QPushButton::clicked, this, [this]() {
+        showPage({m_cursor.sort, m_cursor.position - kPageSize, m_cursor.version});
+    });
+    connect(m_nextBtn, &QPushButton::clicked, this, [this]() {
+        showPage({m_cursor.sort, m_cursor.position + kPageSize, m_cursor.version});
+    });
 
-    auto* list = buildList(m_store->allRecipes());
-    layout->addWidget(list, 1);
+    showPage(m_cursor);
 
     connect(m_store, &RecipeStore::favoritesChanged, this, &HomeView::reload);
+    connect(m_store, &RecipeStore::catalogChanged, this, &HomeView::onCatalogChanged);
+}
+
+void HomeView::onSortChanged(int index) {
+    // Switching the sort only swaps which precomputed order is read; start from the top.
+    showPage({RecipeSort(m_sortBox->itemData(index).toInt()), 0, m_store->catalogVersion()});
+}
+
+void HomeView::onPageChanged(int page) {
+    showPage({m_cursor.sort, (page - 1) * kPageSize, m_cursor.version});
+}
+
+void HomeView::showPage(const PageCursor& cursor) {
+    const auto page = m_store->page(cursor, kPageSize);
+    m_cursor = page.cursor;
+
+    auto* layout = m_list->layout();
+    QLayoutItem* child;
+    while ((child = layout->takeAt(0)) != nullptr) {
+        if (child->widget()) child->widget()->deleteLater();
+        delete child;
+    }
+    layout->addWidget(buildList(page.items));
+    updatePager(page);
+}
+
+void HomeView::onCatalogChanged(const CatalogDiff& diff) {
+    // Stay at the same position in the new order and only replace rows that changed.
+    const auto page = m_store->page(m_cursor, kPageSize);
+    m_cursor = page.cursor;
+    auto* v = cardsLayoutOf(m_list);
+    if (!v) {
+        showPage(m_cursor);
+        return;
+    }
+    auto* container = v->parentWidget();
+    syncCards(v, page.items, diff.touched(), [this, container](const Recipe& r) { return createCard(r, container); });
+    updatePager(page);
+}
+
+void HomeView::updatePager(const RecipePage& page) {
+    const int pages = qMax(1, (page.total + kPageSize - 1) / kPageSize);
+    {
+        QSignalBlocker blocker(m_pageSpin);
+        m_pageSpin->setMaximum(pages);
+        m_pageSpin->setValue(m_cursor.position / kPageSize + 1);
+    }
+    m_pageTotal->setText(QString("of %1").arg(pages));
+    m_prevBtn->setEnabled(page.hasPrev());
+    m_nextBtn->setEnabled(page.hasNext());
 }
 
 QWidget* HomeView::buildList(const QList<Recipe>& items) {
@@ -191,21 +600,7 @@ QWidget* HomeView::buildList(const QList<Recipe>& items) {
     v->setSpacing(10);
 
     for (const auto& r : items) {
-        auto* card = new RecipeCard(r, m_store->isFavorite(r.id), container);
-        v->addWidget(card);
-        connect(card, &RecipeCard::openRequested, this, &HomeView::openRecipe);
-        connect(card, &RecipeCard::favoriteToggled, m_store, &RecipeStore::toggleFavorite);
-        connect(m_store, &RecipeStore::favoritesChanged, card, [this, card, r]() {
-            card->findChild<QPushButton*>()->setDown(false);
-        });
-        // update visual fav icon on change
-        connect(m_store, &RecipeStore::favoritesChanged, card, [this, card, r]() {
-            // hack: reapply icon
-            // safer approach: expose method, but we have pointer
-            // we can dynamic_cast; but we already have direct method
-            // call through lambda capturing card and r
-            // We need to call updateFavIcon; it's private. Workaround: emit toggle and restore? Simpler: rebuild on reload.
-        });
+        v->addWidget(createCard(r, container));
     }
     v->addStretch();
 
@@ -214,18 +609,19 @@ QWidget* HomeView::buildList(const QList<Recipe>& items) {
     return scroll;
 }
 
+RecipeCard* HomeView::createCard(const Recipe& recipe, QWidget* parent) {
+    auto* card = new RecipeCard(recipe, m_store->isFavorite(recipe.id), parent);
+    connect(card, &RecipeCard::openRequested, this, &HomeView::openRecipe);
+    connect(card, &RecipeCard::favoriteToggled, m_store, &RecipeStore::toggleFavorite);
+    connect(m_store, &RecipeStore::favoritesChanged, card, [card]() {
+        card->findChild<QPushButton*>()->setDown(false);
+    });
+    return card;
+}
+
 void HomeView::reload() {
-    // Rebuild list to reflect favorite icons
-    auto layout = qobject_cast<QVBoxLayout*>(this->layout());
-    if (!layout) return;
-    if (layout->count() >= 2) {
-        auto* old = layout->itemAt(1)->widget();
-        if (old) {
-            layout->removeWidget(old);
-            old->deleteLater();
-        }
-    }
-    layout->addWidget(buildList(m_store->allRecipes()), 1);
+    // Rebuild the current page to reflect favorite icons
+    showPage(m_cursor);
 }
 
 // ========== SearchView ==========
@@ -257,6 +653,25 @@ SearchView::SearchView(RecipeStore* store, QWidget* parent)
     connect(m_store, &RecipeStore::favoritesChanged, this, [this]() {
         onTextChanged(m_searchEdit->text());
     });
+    connect(m_store, &RecipeStore::catalogChanged, this, &SearchView::onCatalogChanged);
+}
+
+void SearchView::onCatalogChanged(const CatalogDiff& diff) {
+    const auto results = m_store->search(m_searchEdit->text());
+    auto* v = cardsLayoutOf(m_results);
+    if (!v) {
+        renderResults(results);
+        return;
+    }
+    auto* container = v->parentWidget();
+    syncCards(v, results, diff.touched(), [this, container](const Recipe& r) { return createCard(r, container); });
+}
+
+RecipeCard* SearchView::createCard(const Recipe& recipe, QWidget* parent) {
+    auto* card = new RecipeCard(recipe, m_store->isFavorite(recipe.id), parent);
+    connect(card, &RecipeCard::openRequested, this, &SearchView::openRecipe);
+    connect(card, &RecipeCard::favoriteToggled, m_store, &RecipeStore::toggleFavorite);
+    return card;
 }
 
 void SearchView::onTextChanged(const QString& text) {
@@ -281,10 +696,7 @@ void SearchView::renderResults(const QList<Recipe>& results) {
     v->setSpacing(10);
 
     for (const auto& r : results) {
-        auto* card = new RecipeCard(r, m_store->isFavorite(r.id), container);
-        v->addWidget(card);
-        connect(card, &RecipeCard::openRequested, this, &SearchView::openRecipe);
-        connect(card, &RecipeCard::favoriteToggled, m_store, &RecipeStore::toggleFavorite);
+        v->addWidget(createCard(r, container));
     }
     v->addStretch();
 
@@ -309,6 +721,17 @@ FavoritesView::FavoritesView(RecipeStore* store, QWidget* parent)
 
     reload();
     connect(m_store, &RecipeStore::favoritesChanged, this, &FavoritesView::reload);
+    connect(m_store, &RecipeStore::catalogChanged, this, &FavoritesView::onCatalogChanged);
+}
+
+void FavoritesView::onCatalogChanged(const CatalogDiff& diff) {
+    // Favorites are few; only rebuild when a favorite recipe was added, removed or edited.
+    for (const auto& id : diff.touched()) {
+        if (m_store->isFavorite(id)) {
+            reload();
+            return;
+        }
+    }
 }
 
 void FavoritesView::reload() {
@@ -376,6 +799,11 @@ RecipeDetailView::RecipeDetailView(RecipeStore* store, QWidget* parent)
     m_ingredients = new QLabel(this);
     m_ingredients->setWordWrap(true);
 
+    m_similar = new QWidget(this);
+    auto* similarLayout = new QVBoxLayout(m_similar);
+    similarLayout->setContentsMargins(0, 0, 0, 0);
+    similarLayout->setSpacing(6);
+
     m_favBtn = new QPushButton(this);
     connect(m_favBtn, &QPushButton::clicked, this, &RecipeDetailView::onToggleFavorite);
 
@@ -387,10 +815,32 @@ RecipeDetailView::RecipeDetailView(RecipeStore* store, QWidget* parent)
     layout->addWidget(new QFrame(this), 0);
     layout->addWidget(new QLabel("Ingredients", this));
     layout->addWidget(m_ingredients);
+    layout->addWidget(new QLabel("Similar recipes", this));
+    layout->addWidget(m_similar);
     layout->addStretch();
     layout->addWidget(m_favBtn, 0);
 
     connect(m_store, &RecipeStore::favoritesChanged, this, &RecipeDetailView::refreshFavorite);
+    connect(m_store, &RecipeStore::catalogChanged, this, &RecipeDetailView::onCatalogChanged);
+}
+
+void RecipeDetailView::onCatalogChanged(const CatalogDiff& diff) {
+    if (m_recipe.id.isEmpty()) return;
+    if (diff.removed.contains(m_recipe.id)) {
+        m_subtitle->setText("This recipe was removed from the catalog.");
+        m_favBtn->setEnabled(false);
+        refreshSimilar();
+        return;
+    }
+    // Added covers a recipe that comes back after being removed while it was open.
+    Recipe updated;
+    if ((diff.changed.contains(m_recipe.id) || diff.added.contains(m_recipe.id))
+        && m_store->findRecipe(m_recipe.id, &updated)) {
+        setRecipe(updated);
+    } else {
+        // Neighbours may have moved even when this recipe did not.
+        refreshSimilar();
+    }
 }
 
 void RecipeDetailView::setRecipe(const Recipe& recipe) {
@@ -403,7 +853,31 @@ void RecipeDetailView::setRecipe(const Recipe& recipe) {
     m_desc->setText(recipe.description);
     m_meta->setText(QString("Category: %1").arg(recipe.category));
     m_ingredients->setText("• " + recipe.ingredients.join("\n• "));
+    m_favBtn->setEnabled(true);
     refreshFavorite();
+    refreshSimilar();
+}
+
+void RecipeDetailView::refreshSimilar() {
+    auto* layout = m_similar->layout();
+    QLayoutItem* child;
+    while ((child = layout->takeAt(0)) != nullptr) {
+        if (child->widget()) child->widget()->deleteLater();
+        delete child;
+    }
+
+    const auto items = m_store->similar(m_recipe.id);
+    if (items.isEmpty()) {
+        auto* empty = new QLabel("No similar recipes in this category yet.", m_similar);
+        empty->setObjectName("Subtitle");
+        layout->addWidget(empty);
+        return;
+    }
+    for (const auto& r : items) {
+        auto* btn = new QPushButton(QString("%1 • %2 min").arg(r.title).arg(r.cookMinutes), m_similar);
+        connect(btn, &QPushButton::clicked, this, [this, r]() { emit openRecipe(r); });
+        layout->addWidget(btn);
+    }
 }
 
 void RecipeDetailView::onToggleFavorite() {
@@ -448,7 +922,9 @@ QWidget* MainWindow::createTopNav() {
     return bar;
 }
 
-MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
+MainWindow::MainWindow(const QString& catalogPath, QWidget* parent) : QMainWindow(parent) {
+    m_store.setCatalogPath(catalogPath);
+
     setWindowTitle("Recipe Explorer");
     resize(900, 640);
     setStyleSheet(Theme::baseStyleSheet());
@@ -475,6 +951,7 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
     connect(home, &HomeView::openRecipe, this, &MainWindow::showRecipeDetail);
     connect(search, &SearchView::openRecipe, this, &MainWindow::showRecipeDetail);
     connect(favorites, &FavoritesView::openRecipe, this, &MainWindow::showRecipeDetail);
+    connect(detail, &RecipeDetailView::openRecipe, this, &MainWindow::showRecipeDetail);
     connect(detail, &RecipeDetailView::backRequested, this, [this]() { m_stack->setCurrentIndex(m_homeIndex); });
 
     v->addWidget(topNav, 0);
@@ -484,6 +961,18 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
     setCentralWidget(central);
 
     m_stack->setCurrentIndex(m_homeIndex);
+
+    showCatalogStatus();
+    connect(&m_store, &RecipeStore::catalogChanged, this, &MainWindow::showCatalogStatus);
+}
+
+void MainWindow::showCatalogStatus() {
+    const auto stats = m_store.similarityStats();
+    statusBar()->showMessage(QString("Catalog v%1 • similar-recipes index: %2 recipes, built in %3 ms, %4 KiB")
+                                 .arg(m_store.catalogVersion())
+                                 .arg(stats.recipes)
+                                 .arg(stats.buildMs)
+                                 .arg(stats.bytes / 1024.0, 0, 'f', 1));
 }
 
 void MainWindow::navigateHome() { m_stack->setCurrentIndex(m_homeIndex); }
@@ -502,11 +991,91 @@ void MainWindow::showRecipeDetail(const Recipe& recipe) {
 }
 
 // ========== main ==========
+namespace {
+
+// --serve must be known before the application object exists: QApplication needs a display.
+bool wantsServe(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--serve") == 0) return true;
+    }
+    return false;
+}
+
+#ifdef Q_OS_UNIX
+int g_signalPipe[2] = {-1, -1};
+
+void onQuitSignal(int) {
+    const char c = 1;
+    (void)::write(g_signalPipe[1], &c, 1); // async-signal-safe; the event loop does the rest
+}
+
+// Turns SIGINT/SIGTERM into QCoreApplication::quit(), so destructors run: the store writes
+// favorites still waiting on its save timer and the server closes and removes its socket.
+void quitOnSignals(QCoreApplication* app) {
+    if (::pipe(g_signalPipe) != 0) {
+        qWarning() << "Cannot install signal handlers; SIGINT/SIGTERM will skip saving favorites";
+        return;
+    }
+    auto* notifier = new QSocketNotifier(g_signalPipe[0], QSocketNotifier::Read, app);
+    QObject::connect(notifier, &QSocketNotifier::activated, app, [notifier]() {
+        char c;
+        (void)::read(g_signalPipe[0], &c, 1);
+        notifier->setEnabled(false);
+        qInfo() << "Shutting down";
+        QCoreApplication::quit();
+    });
+
+    struct sigaction action {};
+    action.sa_handler = onQuitSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+}
+#endif
+
+} // namespace
+
 int main(int argc, char *argv[]) {
-    QApplication app(argc, argv);
+    const bool serve = wantsServe(argc, argv);
+    std::unique_ptr<QCoreApplication> app(serve ? new QCoreApplication(argc, argv)
+                                                : new QApplication(argc, argv));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Recipe Explorer");
+    parser.addHelpOption();
+    QCommandLineOption catalogOption("catalog", "Load recipes from a JSON catalog file and reload it on change.", "path");
+    QCommandLineOption serveOption("serve", "Run headless and serve queries over a local socket instead of opening a window.");
+    QCommandLineOption socketOption("socket", "Local socket name used with --serve.", "name", "recipe-explorer");
+    QCommandLineOption threadsOption("threads", "Worker threads used with --serve (default: one per core).", "count", "0");
+    QCommandLineOption settingsOption("settings",
+        "QSettings application name holding favorites (default: RecipeApp). "
+        "Use a separate one when benchmarking --serve so favorite toggles do not touch saved favorites.", "name");
+    parser.addOption(catalogOption);
+    parser.addOption(serveOption);
+    parser.addOption(socketOption);
+    parser.addOption(threadsOption);
+    parser.addOption(settingsOption);
+    parser.process(*app);
+
+    if (serve) {
+        RecipeStore store;
+        if (parser.isSet(settingsOption)) store.setSettingsName(parser.value(settingsOption));
+        store.setCatalogPath(parser.value(catalogOption));
+        QueryServer server(&store);
+        if (!server.listen(parser.value(socketOption), parser.value(threadsOption).toInt())) {
+            qCritical().noquote() << QString("Cannot listen on %1: %2")
+                                         .arg(parser.value(socketOption), server.errorString());
+            return 1;
+        }
+#ifdef Q_OS_UNIX
+        quitOnSignals(app.get());
+#endif
+        return app->exec();
+    }
 
-    MainWindow window;
+    MainWindow window(parser.value(catalogOption));
     window.show();
 
-    return app.exec();
+    return app->exec();
 }
@@ -0,0 +1,31 @@
+#include "queryProtocol.h"
+
+#include <QCborValue>
+#include <QtEndian>
+
+QByteArray QueryProtocol::encodeFrame(const QCborMap& message) {
+    const QByteArray payload = message.toCborValue().toCbor();
+    QByteArray frame(4, Qt::Uninitialized);
+    qToBigEndian<quint32>(quint32(payload.size()), frame.data());
+    frame.append(payload);
+    return frame;
+}
+
+bool QueryProtocol::takeFrames(QByteArray* buffer, QList<QCborMap>* out) {
+    qsizetype offset = 0;
+    bool ok = true;
+    while (buffer->size() - offset >= 4) {
+        const quint32 length = qFromBigEndian<quint32>(buffer->constData() + offset);
+        if (length > kMaxFrameBytes) {
+            ok = false;
+            break;
+        }
+        if (buffer->size() - offset - 4 < qsizetype(length)) break;
+        // Anything that is not a map decodes to an empty one and is rejected by the handler.
+        out->push_back(QCborValue::fromCbor(buffer->mid(offset + 4, length)).toMap());
+        offset += 4 + length;
+    }
+    // Drop consumed frames in one go so a long pipeline is not shifted once per frame.
+    if (offset > 0) buffer->remove(0, offset);
+    return ok;
+}
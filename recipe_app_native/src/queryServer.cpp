@@ -0,0 +1,331 @@
+#include "queryServer.h"
+#include "queryProtocol.h"
+#include "mainApp.h"
+
+#include <QCborArray>
+#include <QDebug>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+const char* const kEndpointNames[] = {"search", "facets", "lookup", "favorite", "stats", "invalid"};
+
+QCborMap recipeSummary(const Recipe& r, bool favorite) {
+    QCborMap m;
+    m.insert(QStringLiteral("id"), r.id);
+    m.insert(QStringLiteral("title"), r.title);
+    m.insert(QStringLiteral("category"), r.category);
+    m.insert(QStringLiteral("cookMinutes"), r.cookMinutes);
+    m.insert(QStringLiteral("calories"), r.calories);
+    m.insert(QStringLiteral("favorite"), favorite);
+    return m;
+}
+
+QCborValue runSearch(RecipeStore* store, const QCborMap& request) {
+    const auto results = store->search(request.value(QStringLiteral("q")).toString());
+    const qint64 total = results.size();
+    const qint64 offset = qBound<qint64>(0, request.value(QStringLiteral("offset")).toInteger(0), total);
+    const qint64 limit = qBound<qint64>(0, request.value(QStringLiteral("limit")).toInteger(20), 500);
+
+    QCborArray items;
+    for (qint64 i = offset, end = qMin<qint64>(total, offset + limit); i < end; ++i) {
+        items.append(recipeSummary(results[i], store->isFavorite(results[i].id)));
+    }
+    QCborMap out;
+    out.insert(QStringLiteral("total"), results.size());
+    out.insert(QStringLiteral("items"), items);
+    return out;
+}
+
+QCborValue runFacets(RecipeStore* store, const QCborMap& request) {
+    QHash<QString, int> counts;
+    for (const auto& r : store->search(request.value(QStringLiteral("q")).toString())) ++counts[r.category];
+    QCborMap categories;
+    for (auto it = counts.constBegin(); it != counts.constEnd(); ++it) categories.insert(it.key(), it.value());
+    QCborMap out;
+    out.insert(QStringLiteral("categories"), categories);
+    return out;
+}
+
+QCborValue runLookup(RecipeStore* store, const QCborMap& request, QString* error) {
+    const auto id = request.value(QStringLiteral("recipeId")).toString();
+    Recipe r;
+    if (!store->findRecipe(id, &r)) {
+        *error = QString("unknown recipe '%1'").arg(id);
+        return {};
+    }
+    auto out = recipeSummary(r, store->isFavorite(r.id));
+    out.insert(QStringLiteral("description"), r.description);
+    out.insert(QStringLiteral("ingredients"), QCborArray::fromStringList(r.ingredients));
+    out.insert(QStringLiteral("image"), r.image);
+    return out;
+}
+
+QCborValue runFavorite(RecipeStore* store, const QCborMap& request, QString* error) {
+    const auto id = request.value(QStringLiteral("recipeId")).toString();
+    Recipe r;
+    if (!store->findRecipe(id, &r)) {
+        *error = QString("unknown recipe '%1'").arg(id);
+        return {};
+    }
+    QCborMap out;
+    out.insert(QStringLiteral("favorite"), store->toggleFavorite(id));
+    return out;
+}
+
+// Requests that change state; they never run concurrently with their neighbours.
+bool isMutating(const QCborMap& request) {
+    return request.value(QStringLiteral("op")).toString() == QLatin1String("favorite");
+}
+
+} // namespace
+
+QueryServer::QueryServer(RecipeStore* store, QObject* parent)
+    : QObject(parent), m_store(store) {
+    m_server = new QLocalServer(this);
+    connect(m_server, &QLocalServer::newConnection, this, &QueryServer::onNewConnection);
+}
+
+QueryServer::~QueryServer() {
+    // Stop accepting and remove the socket name first, then let running batches finish
+    // while the store is still alive.
+    m_server->close();
+    m_pool.waitForDone();
+}
+
+bool QueryServer::listen(const QString& name, int threads) {
+    m_pool.setMaxThreadCount(threads > 0 ? threads : QThread::idealThreadCount());
+
+    // Only clear the name when nobody answers on it: a socket left behind by a crashed run.
+    QLocalSocket probe;
+    probe.connectToServer(name);
+    if (probe.waitForConnected(500)) {
+        probe.disconnectFromServer();
+        m_error = QString("another server is already listening on '%1'").arg(name);
+        return false;
+    }
+    QLocalServer::removeServer(name);
+    if (!m_server->listen(name)) {
+        m_error = m_server->errorString();
+        return false;
+    }
+    m_uptime.start();
+    qInfo().noquote() << QString("Serving on %1 with %2 worker threads")
+                             .arg(m_server->fullServerName())
+                             .arg(m_pool.maxThreadCount());
+    return true;
+}
+
+QString QueryServer::errorString() const {
+    return m_error;
+}
+
+void QueryServer::onNewConnection() {
+    while (auto* socket = m_server->nextPendingConnection()) {
+        const quint64 id = m_nextConnectionId++;
+        socket->setReadBufferSize(kReadBufferBytes);
+        m_connections.insert(id, Connection{socket});
+        connect(socket, &QLocalSocket::readyRead, this, [this, id]() { onReadyRead(id); });
+        // Replies drained: a paused connection may start its next batch and read again.
+        connect(socket, &QLocalSocket::bytesWritten, this, [this, id]() {
+            dispatch(id);
+            onReadyRead(id);
+        });
+        connect(socket, &QLocalSocket::disconnected, this, [this, id, socket]() {
+            m_connections.remove(id);
+            socket->deleteLater();
+        });
+    }
+}
+
+bool QueryServer::isBackedUp(const Connection& connection) const {
+    return connection.queued.size() >= kMaxQueuedFrames
+        || connection.socket->bytesToWrite() >= kMaxPendingWriteBytes;
+}
+
+void QueryServer::onReadyRead(quint64 connectionId) {
+    auto it = m_connections.find(connectionId);
+    if (it == m_connections.end()) return;
+    // Leave the data with the socket; finishBatch or bytesWritten calls back here.
+    if (isBackedUp(*it) || it->socket->bytesAvailable() == 0) return;
+    it->buffer.append(it->socket->readAll());
+    const int before = it->queued.size();
+    if (!QueryProtocol::takeFrames(&it->buffer, &it->queued)) {
+        qWarning() << "Dropping client that sent an oversized frame";
+        it->socket->disconnectFromServer();
+        return;
+    }
+    const qint64 now = m_uptime.nsecsElapsed();
+    for (int i = before; i < it->queued.size(); ++i) it->queuedAtNs.append(now);
+    dispatch(connectionId);
+}
+
+void QueryServer::dispatch(quint64 connectionId) {
+    auto it = m_connections.find(connectionId);
+    if (it == m_connections.end() || it->busy || it->queued.isEmpty()) return;
+    // Don't produce more replies for a client that isn't reading the ones it has.
+    if (it->socket->bytesToWrite() >= kMaxPendingWriteBytes) return;
+    it->busy = true;
+
+    auto batch = std::make_shared<Batch>();
+    batch->connectionId = connectionId;
+    const int n = qMin<int>(it->queued.size(), kMaxBatchFrames);
+    batch->requests = it->queued.mid(0, n);
+    batch->receivedAtNs = it->queuedAtNs.mid(0, n);
+    it->queued.remove(0, n);
+    it->queuedAtNs.remove(0, n);
+    batch->replies.resize(n);
+    batch->endpoints.resize(n, Invalid);
+    batch->failed.resize(n, 0);
+    m_batches.fetch_add(1, std::memory_order_relaxed);
+    m_batchedRequests.fetch_add(n, std::memory_order_relaxed);
+
+    // Mutating requests are barriers, so a pipeline takes effect in the order it was sent.
+    int runStart = 0;
+    for (int i = 0; i < n; ++i) {
+        if (!isMutating(batch->requests[i])) continue;
+        if (runStart < i) batch->phases.push_back({runStart, i});
+        batch->phases.push_back({i, i + 1});
+        runStart = i + 1;
+    }
+    if (runStart < n) batch->phases.push_back({runStart, n});
+    runPhase(batch, 0);
+}
+
+void QueryServer::runPhase(const std::shared_ptr<Batch>& batch, int phase) {
+    if (phase == int(batch->phases.size())) {
+        QMetaObject::invokeMethod(this, [this, batch]() { finishBatch(batch); }, Qt::QueuedConnection);
+        return;
+    }
+
+    const auto [first, last] = batch->phases[phase];
+    const int n = last - first;
+    const int chunks = qBound(1, n / kMinChunk, m_pool.maxThreadCount());
+    batch->remaining.store(chunks);
+    for (int c = 0; c < chunks; ++c) {
+        const int begin = first + int(qint64(n) * c / chunks);
+        const int end = first + int(qint64(n) * (c + 1) / chunks);
+        m_pool.start([this, batch, phase, begin, end]() {
+            for (int i = begin; i < end; ++i) {
+                const auto reply = handle(batch->requests[i], &batch->endpoints[i]);
+                batch->failed[i] = !reply.value(QStringLiteral("ok")).toBool();
+                batch->replies[i] = QueryProtocol::encodeFrame(reply);
+            }
+            // Last chunk of this phase starts the next one.
+            if (batch->remaining.fetch_sub(1) == 1) runPhase(batch, phase + 1);
+        });
+    }
+}
+
+void QueryServer::finishBatch(const std::shared_ptr<Batch>& batch) {
+    const quint64 connectionId = batch->connectionId;
+    auto it = m_connections.find(connectionId);
+    if (it == m_connections.end()) return; // client went away mid-batch
+
+    // Assemble the replies in request order.
+    QByteArray out;
+    for (const auto& reply : batch->replies) out.append(reply);
+    it->socket->write(out);
+
+    const qint64 nowNs = m_uptime.nsecsElapsed();
+    const qint64 second = nowNs / 1000000000;
+    {
+        QMutexLocker locker(&m_countersLock);
+        for (int i = 0; i < batch->requests.size(); ++i) {
+            const quint64 us = quint64(qMax<qint64>(0, nowNs - batch->receivedAtNs[i]) / 1000);
+            auto& counters = m_counters[batch->endpoints[i]];
+            auto& recent = counters.recent[second % (kWindowSeconds + 1)];
+            if (recent.second != second) recent = Bucket{second};
+            for (Bucket* bucket : {&counters.lifetime, &recent}) {
+                ++bucket->requests;
+                if (batch->failed[i]) ++bucket->errors;
+                bucket->totalUs += us;
+                bucket->maxUs = qMax(bucket->maxUs, us);
+            }
+        }
+    }
+
+    it->busy = false;
+    dispatch(connectionId);
+    onReadyRead(connectionId); // reading may have paused on a full queue
+}
+
+QCborMap QueryServer::handle(const QCborMap& request, Endpoint* endpointOut) {
+    const auto op = request.value(QStringLiteral("op")).toString();
+    Endpoint endpoint = Invalid;
+    for (int e = 0; e < Invalid; ++e) {
+        if (op == QLatin1String(kEndpointNames[e])) endpoint = Endpoint(e);
+    }
+
+    QString error;
+    QCborValue result;
+    switch (endpoint) {
+    case Search: result = runSearch(m_store, request); break;
+    case Facets: result = runFacets(m_store, request); break;
+    case Lookup: result = runLookup(m_store, request, &error); break;
+    case Favorite: result = runFavorite(m_store, request, &error); break;
+    case Stats: result = stats(); break;
+    default: error = QString("unknown op '%1'").arg(op); break;
+    }
+    *endpointOut = endpoint;
+
+    QCborMap reply;
+    reply.insert(QStringLiteral("id"), request.value(QStringLiteral("id")));
+    reply.insert(QStringLiteral("ok"), error.isEmpty());
+    if (error.isEmpty()) {
+        reply.insert(QStringLiteral("result"), result);
+    } else {
+        reply.insert(QStringLiteral("error"), error);
+    }
+    return reply;
+}
+
+QCborValue QueryServer::stats() const {
+    const qint64 uptimeMs = qMax<qint64>(1, m_uptime.elapsed());
+    const qint64 now = uptimeMs / 1000;
+    // Only full seconds count towards the window; fewer than kWindowSeconds right after start.
+    const qint64 windowSeconds = qMin<qint64>(kWindowSeconds, now);
+
+    auto describe = [](const Bucket& b, double seconds) {
+        QCborMap m;
+        m.insert(QStringLiteral("requests"), qint64(b.requests));
+        m.insert(QStringLiteral("errors"), qint64(b.errors));
+        m.insert(QStringLiteral("qps"), seconds > 0 ? b.requests / seconds : 0.0);
+        m.insert(QStringLiteral("avgUs"), b.requests ? double(b.totalUs) / b.requests : 0.0);
+        m.insert(QStringLiteral("maxUs"), qint64(b.maxUs));
+        return m;
+    };
+
+    QCborMap endpoints;
+    {
+        QMutexLocker locker(&m_countersLock);
+        for (int e = 0; e < EndpointCount; ++e) {
+            const auto& counters = m_counters[e];
+            Bucket window;
+            for (const auto& b : counters.recent) {
+                if (b.second < now - windowSeconds || b.second >= now) continue;
+                window.requests += b.requests;
+                window.errors += b.errors;
+                window.totalUs += b.totalUs;
+                window.maxUs = qMax(window.maxUs, b.maxUs);
+            }
+            auto m = describe(counters.lifetime, uptimeMs / 1000.0);
+            m.insert(QStringLiteral("recent"), describe(window, double(windowSeconds)));
+            endpoints.insert(QString::fromLatin1(kEndpointNames[e]), m);
+        }
+    }
+    const quint64 batches = m_batches.load(std::memory_order_relaxed);
+    QCborMap out;
+    out.insert(QStringLiteral("uptimeSeconds"), uptimeMs / 1000.0);
+    out.insert(QStringLiteral("windowSeconds"), windowSeconds);
+    out.insert(QStringLiteral("batches"), qint64(batches));
+    out.insert(QStringLiteral("avgBatchSize"),
+               batches ? double(m_batchedRequests.load(std::memory_order_relaxed)) / batches : 0.0);
+    out.insert(QStringLiteral("endpoints"), endpoints);
+    return out;
+}
@@ -0,0 +1,70 @@
+// Benchmark for SimilarityIndex: builds a synthetic catalog (1M recipes by default) and
+// reports build time, memory and per-lookup latency.
+
+#include "mainApp.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTextStream>
+
+#include <algorithm>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Similar-recipes index benchmark");
+    parser.addHelpOption();
+    QCommandLineOption recipesOption("recipes", "Synthetic catalog size.", "count", "1000000");
+    QCommandLineOption lookupsOption("lookups", "Number of timed lookups.", "count", "10000");
+    parser.addOptions({recipesOption, lookupsOption});
+    parser.process(app);
+
+    const int n = qMax(1, parser.value(recipesOption).toInt());
+    const int lookups = qMax(1, parser.value(lookupsOption).toInt());
+
+    // 8 categories, 5-9 ingredients drawn from a 2000-ingredient vocabulary.
+    QRandomGenerator rng(1);
+    const QStringList categories = {"Seafood", "Pasta", "Breakfast", "Salad", "Asian", "Dessert", "Soup", "Grill"};
+    QList<Recipe> recipes;
+    recipes.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        Recipe r{QString("r%1").arg(i), QString(), categories[rng.bounded(int(categories.size()))], QString(), {}, 0, 0, QString()};
+        const int count = 5 + rng.bounded(5);
+        for (int j = 0; j < count; ++j) r.ingredients.push_back(QString("ingredient %1").arg(rng.bounded(2000)));
+        recipes.push_back(r);
+    }
+
+    SimilarityIndex index;
+    index.build(recipes);
+    const auto stats = index.stats();
+
+    std::vector<qint64> latencies;
+    latencies.reserve(lookups);
+    qint64 found = 0;
+    QElapsedTimer timer;
+    for (int i = 0; i < lookups; ++i) {
+        const int row = rng.bounded(n);
+        timer.start();
+        found += index.similar(row, 5).size();
+        latencies.push_back(timer.nsecsElapsed());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    const auto at = [&latencies](double p) { return latencies[size_t(p * (latencies.size() - 1))] / 1000.0; };
+
+    QTextStream out(stdout);
+    out << QString("recipes=%1 build=%2 ms memory=%3 MiB\n")
+               .arg(stats.recipes)
+               .arg(stats.buildMs)
+               .arg(stats.bytes / (1024.0 * 1024.0), 0, 'f', 1);
+    out << QString("lookups=%1 results=%2 latency us: p50=%3 p99=%4 max=%5\n")
+               .arg(lookups)
+               .arg(found)
+               .arg(at(0.50), 0, 'f', 1)
+               .arg(at(0.99), 0, 'f', 1)
+               .arg(latencies.back() / 1000.0, 0, 'f', 1);
+    return 0;
+}
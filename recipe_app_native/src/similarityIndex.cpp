@@ -0,0 +1,165 @@
+#include "similarityIndex.h"
+#include "mainApp.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// splitmix64 finalizer; cheap and well distributed for deriving hash families.
+quint64 mix64(quint64 x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+QString normalizeIngredient(const QString& ingredient) {
+    return ingredient.trimmed().toLower();
+}
+
+} // namespace
+
+void SimilarityIndex::build(const QList<Recipe>& recipes) {
+    QElapsedTimer timer;
+    timer.start();
+
+    const int n = recipes.size();
+    for (auto& band : m_bands) band.clear();
+    m_tokenOffsets.clear();
+    m_tokens.clear();
+    m_tokenHashes.clear();
+    m_categories.clear();
+
+    QHash<QString, quint32> tokenIds;
+    QHash<QString, quint32> categoryIds;
+    m_tokenOffsets.reserve(n + 1);
+    m_categories.reserve(n);
+    m_tokenOffsets.push_back(0);
+
+    std::vector<quint32> rowTokens;
+    for (const auto& r : recipes) {
+        rowTokens.clear();
+        for (const auto& ing : r.ingredients) {
+            const auto key = normalizeIngredient(ing);
+            if (key.isEmpty()) continue;
+            auto it = tokenIds.constFind(key);
+            if (it == tokenIds.constEnd()) {
+                it = tokenIds.insert(key, quint32(m_tokenHashes.size()));
+                m_tokenHashes.push_back(mix64(qHash(key, 0)));
+            }
+            rowTokens.push_back(it.value());
+        }
+        std::sort(rowTokens.begin(), rowTokens.end());
+        rowTokens.erase(std::unique(rowTokens.begin(), rowTokens.end()), rowTokens.end());
+        m_tokens.insert(m_tokens.end(), rowTokens.begin(), rowTokens.end());
+        m_tokenOffsets.push_back(quint32(m_tokens.size()));
+
+        auto cat = categoryIds.constFind(r.category);
+        if (cat == categoryIds.constEnd()) cat = categoryIds.insert(r.category, quint32(categoryIds.size()));
+        m_categories.push_back(cat.value());
+    }
+
+    for (auto& band : m_bands) band.reserve(n);
+    quint32 keys[kBands];
+    for (int row = 0; row < n; ++row) {
+        if (m_tokenOffsets[row] == m_tokenOffsets[row + 1]) continue; // nothing to compare on
+        bandKeys(row, keys);
+        for (int b = 0; b < kBands; ++b) m_bands[b].push_back({keys[b], quint32(row)});
+    }
+    for (auto& band : m_bands) {
+        std::sort(band.begin(), band.end(), [](const BandEntry& a, const BandEntry& b) {
+            return a.key != b.key ? a.key < b.key : a.row < b.row;
+        });
+    }
+
+    qint64 bytes = qint64(m_tokenOffsets.capacity() + m_tokens.capacity() + m_categories.capacity()) * sizeof(quint32)
+                 + qint64(m_tokenHashes.capacity()) * sizeof(quint64);
+    for (const auto& band : m_bands) bytes += qint64(band.capacity()) * sizeof(BandEntry);
+
+    m_stats.recipes = n;
+    m_stats.bytes = bytes;
+    m_stats.buildMs = timer.elapsed();
+}
+
+void SimilarityIndex::bandKeys(int row, quint32* keys) const {
+    quint64 mins[kHashes];
+    std::fill(std::begin(mins), std::end(mins), std::numeric_limits<quint64>::max());
+    for (quint32 t = m_tokenOffsets[row]; t < m_tokenOffsets[row + 1]; ++t) {
+        const quint64 base = m_tokenHashes[m_tokens[t]];
+        for (int i = 0; i < kHashes; ++i) {
+            const quint64 h = mix64(base ^ (quint64(i + 1) * 0xD6E8FEB86659FD93ULL));
+            if (h < mins[i]) mins[i] = h;
+        }
+    }
+    // The category is folded into every band key so buckets never mix categories.
+    for (int b = 0; b < kBands; ++b) {
+        quint64 h = mix64((quint64(m_categories[row]) << 8) | quint64(b));
+        for (int r = 0; r < kRowsPerBand; ++r) h = mix64(h ^ mins[b * kRowsPerBand + r]);
+        keys[b] = quint32(h ^ (h >> 32));
+    }
+}
+
+double SimilarityIndex::jaccard(int a, int b) const {
+    quint32 i = m_tokenOffsets[a], iEnd = m_tokenOffsets[a + 1];
+    quint32 j = m_tokenOffsets[b], jEnd = m_tokenOffsets[b + 1];
+    const quint32 total = (iEnd - i) + (jEnd - j);
+    quint32 shared = 0;
+    while (i < iEnd && j < jEnd) {
+        if (m_tokens[i] == m_tokens[j]) { ++shared; ++i; ++j; }
+        else if (m_tokens[i] < m_tokens[j]) ++i;
+        else ++j;
+    }
+    return total == shared ? 0.0 : double(shared) / double(total - shared);
+}
+
+QVector<int> SimilarityIndex::similar(int row, int limit) const {
+    QVector<int> out;
+    if (row < 0 || row >= m_stats.recipes || limit <= 0) return out;
+    if (m_tokenOffsets[row] == m_tokenOffsets[row + 1]) return out;
+
+    quint32 keys[kBands];
+    bandKeys(row, keys);
+
+    std::vector<quint32> candidates;
+    for (int b = 0; b < kBands; ++b) {
+        const auto& band = m_bands[b];
+        auto it = std::lower_bound(band.begin(), band.end(), keys[b], [](const BandEntry& e, quint32 key) {
+            return e.key < key;
+        });
+        const auto end = std::upper_bound(it, band.end(), keys[b], [](quint32 key, const BandEntry& e) {
+            return key < e.key;
+        });
+        const size_t size = size_t(end - it);
+        if (size == 0) continue;
+        // Crowded buckets are sampled evenly from a per-query starting point, so later rows
+        // get suggested as often as the low row numbers the bucket happens to start with.
+        const size_t samples = std::min<size_t>(size, kMaxBucketScan);
+        const size_t stride = size / samples;
+        const size_t start = size > samples ? size_t(mix64((quint64(row) << 8) | quint64(b)) % size) : 0;
+        for (size_t i = 0; i < samples; ++i) {
+            const auto& entry = it[(start + i * stride) % size];
+            // 32-bit keys can collide across categories; re-check.
+            if (int(entry.row) != row && m_categories[entry.row] == m_categories[row]) candidates.push_back(entry.row);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    std::vector<std::pair<double, quint32>> scored;
+    scored.reserve(candidates.size());
+    for (quint32 c : candidates) {
+        const double score = jaccard(row, int(c));
+        if (score > 0.0) scored.push_back({score, c});
+    }
+    const auto take = std::min<size_t>(size_t(limit), scored.size());
+    std::partial_sort(scored.begin(), scored.begin() + take, scored.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    out.reserve(int(take));
+    for (size_t i = 0; i < take; ++i) out.push_back(int(scored[i].second));
+    return out;
+}
@@ -0,0 +1,69 @@
+#include "sortIndex.h"
+#include "mainApp.h"
+
+#include <QCollator>
+#include <QElapsedTimer>
+#include <QHash>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+void SortIndex::build(const QList<Recipe>& recipes) {
+    QElapsedTimer timer;
+    timer.start();
+
+    const int n = recipes.size();
+    QCollator collator;
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    collator.setNumericMode(true);
+
+    // Title: compare precomputed sort keys instead of collating strings on every comparison.
+    std::vector<QCollatorSortKey> titleKeys;
+    titleKeys.reserve(n);
+    for (const auto& r : recipes) titleKeys.push_back(collator.sortKey(r.title));
+
+    QVector<int> byTitle(n);
+    std::iota(byTitle.begin(), byTitle.end(), 0);
+    std::sort(byTitle.begin(), byTitle.end(), [&titleKeys](int a, int b) {
+        const int c = titleKeys[a].compare(titleKeys[b]);
+        return c != 0 ? c < 0 : a < b;
+    });
+    titleKeys.clear();
+    titleKeys.shrink_to_fit();
+
+    // The remaining orders are stable sorts of the title order, so ties read alphabetically.
+    QVector<int> byCookTime = byTitle;
+    std::stable_sort(byCookTime.begin(), byCookTime.end(), [&recipes](int a, int b) {
+        return recipes[a].cookMinutes < recipes[b].cookMinutes;
+    });
+
+    QVector<int> byCalories = byTitle;
+    std::stable_sort(byCalories.begin(), byCalories.end(), [&recipes](int a, int b) {
+        return recipes[a].calories < recipes[b].calories;
+    });
+
+    // Categories are few; collate the distinct names once and sort rows by rank.
+    QHash<QString, int> categoryRank;
+    for (const auto& r : recipes) categoryRank.insert(r.category, 0);
+    QStringList categories = categoryRank.keys();
+    std::sort(categories.begin(), categories.end(), collator);
+    for (int i = 0; i < categories.size(); ++i) categoryRank[categories[i]] = i;
+
+    std::vector<int> rowRank(n);
+    for (int i = 0; i < n; ++i) rowRank[i] = categoryRank.value(recipes[i].category);
+    QVector<int> byCategory = byTitle;
+    std::stable_sort(byCategory.begin(), byCategory.end(), [&rowRank](int a, int b) {
+        return rowRank[a] < rowRank[b];
+    });
+
+    m_orders[int(RecipeSort::Title)] = std::move(byTitle);
+    m_orders[int(RecipeSort::CookTime)] = std::move(byCookTime);
+    m_orders[int(RecipeSort::Calories)] = std::move(byCalories);
+    m_orders[int(RecipeSort::Category)] = std::move(byCategory);
+    for (int s = 0; s < kSortCount; ++s) {
+        m_positions[s].resize(n);
+        for (int i = 0; i < n; ++i) m_positions[s][m_orders[s][i]] = i;
+    }
+    m_buildMs = timer.elapsed();
+}